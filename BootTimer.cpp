@@ -0,0 +1,40 @@
+#include "BootTimer.h"
+#include <Arduino.h>
+#include <esp_timer.h>
+
+BootTimer::BootTimer() {
+  for (int i = 0; i < BOOT_PHASE_COUNT; i++) {
+    timestamps[i] = 0;
+    reachedFlags[i] = false;
+  }
+}
+
+void BootTimer::mark(BootPhase phase) {
+  if (phase >= BOOT_PHASE_COUNT || reachedFlags[phase]) return;
+
+  uint64_t now = (uint64_t)esp_timer_get_time();
+  timestamps[phase] = now;
+  reachedFlags[phase] = true;
+  Serial.printf("[boot] %s +%llu us\n", phaseName(phase), (unsigned long long)now);
+}
+
+bool BootTimer::reached(BootPhase phase) const {
+  return phase < BOOT_PHASE_COUNT && reachedFlags[phase];
+}
+
+uint64_t BootTimer::get(BootPhase phase) const {
+  if (!reached(phase)) return 0;
+  return timestamps[phase];
+}
+
+const char* BootTimer::phaseName(BootPhase phase) {
+  switch (phase) {
+    case BOOT_SETUP_START: return "setup_start";
+    case BOOT_HID_STARTED: return "hid_started";
+    case BOOT_SETTINGS_LOADED: return "settings_loaded";
+    case BOOT_ADVERTISING: return "advertising";
+    case BOOT_FIRST_REPORT: return "first_report";
+    case BOOT_WEB_STARTED: return "web_started";
+    default: return "unknown";
+  }
+}
@@ -0,0 +1,34 @@
+#ifndef BOOT_TIMER_H
+#define BOOT_TIMER_H
+
+#include <stdint.h>
+
+enum BootPhase : uint8_t {
+  BOOT_SETUP_START = 0,
+  BOOT_HID_STARTED,
+  BOOT_SETTINGS_LOADED,
+  BOOT_ADVERTISING,
+  BOOT_FIRST_REPORT,
+  BOOT_WEB_STARTED,
+  BOOT_PHASE_COUNT
+};
+
+// Records the first time each boot phase is reached, in esp_timer microseconds.
+// esp_timer starts after the ROM and second-stage bootloader have run, so these
+// times leave out the bootloader share of power-on time.
+class BootTimer {
+public:
+  BootTimer();
+
+  void mark(BootPhase phase);
+  bool reached(BootPhase phase) const;
+  uint64_t get(BootPhase phase) const;
+
+  static const char* phaseName(BootPhase phase);
+
+private:
+  volatile uint64_t timestamps[BOOT_PHASE_COUNT];
+  volatile bool reachedFlags[BOOT_PHASE_COUNT];
+};
+
+#endif
@@ -10,9 +10,28 @@ struct CalAxis {
   int index;
 };
 
-struct Settings {
+#define STICK_CURVE_POINTS 9
+
+enum StickCurve : uint8_t {
+  STICK_CURVE_LINEAR = 0,
+  STICK_CURVE_EXPONENTIAL = 1,
+  STICK_CURVE_CUSTOM = 2
+};
+
+struct StickShape {
   float deadzone_percent;
+  float outer_deadzone_percent;
+  float anti_deadzone_percent;
+  float circularity_percent;
+  uint8_t curve;
+  float expo_percent;
+  // Output percent at evenly spaced input magnitudes 0..100%
+  uint8_t curve_points[STICK_CURVE_POINTS];
+};
+
+struct Settings {
   CalAxis LX, LY, RX, RY;
+  StickShape left, right;
 };
 
 struct RawAxisData {
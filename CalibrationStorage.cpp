@@ -1,14 +1,28 @@
 #include "CalibrationStorage.h"
 #include <stdio.h>
+#include <string.h>
 
 CalibrationStorage::CalibrationStorage() {}
 
+void CalibrationStorage::loadDefaultShape(StickShape& shape) {
+  shape.deadzone_percent = 5.0f;
+  shape.outer_deadzone_percent = 0.0f;
+  shape.anti_deadzone_percent = 0.0f;
+  shape.circularity_percent = 0.0f;
+  shape.curve = STICK_CURVE_LINEAR;
+  shape.expo_percent = 0.0f;
+  for (int i = 0; i < STICK_CURVE_POINTS; i++) {
+    shape.curve_points[i] = (uint8_t)(i * 100 / (STICK_CURVE_POINTS - 1));
+  }
+}
+
 void CalibrationStorage::loadDefaults(Settings& settings) {
-  settings.deadzone_percent = 5.0f;
   settings.LX = { 470, 1960, 3845, 0 };
   settings.LY = {   0, 1927, 3180, 1 };
   settings.RX = { 302, 1975, 3900, 2 };
   settings.RY = { 170, 1940, 3538, 3 };
+  loadDefaultShape(settings.left);
+  loadDefaultShape(settings.right);
 }
 
 void CalibrationStorage::putAxisNVS(const char* prefix, const CalAxis& axis) {
@@ -35,22 +49,70 @@ void CalibrationStorage::getAxisNVS(const char* prefix, CalAxis& axis, const Cal
   axis.index = prefs.getInt(key, defaultAxis.index);
 }
 
+void CalibrationStorage::putShapeNVS(const char* prefix, const StickShape& shape) {
+  char key[12];
+  snprintf(key, sizeof(key), "%sdz", prefix);
+  prefs.putFloat(key, shape.deadzone_percent);
+  snprintf(key, sizeof(key), "%sodz", prefix);
+  prefs.putFloat(key, shape.outer_deadzone_percent);
+  snprintf(key, sizeof(key), "%sadz", prefix);
+  prefs.putFloat(key, shape.anti_deadzone_percent);
+  snprintf(key, sizeof(key), "%scirc", prefix);
+  prefs.putFloat(key, shape.circularity_percent);
+  snprintf(key, sizeof(key), "%scurve", prefix);
+  prefs.putUChar(key, shape.curve);
+  snprintf(key, sizeof(key), "%sexpo", prefix);
+  prefs.putFloat(key, shape.expo_percent);
+  snprintf(key, sizeof(key), "%spts", prefix);
+  prefs.putBytes(key, shape.curve_points, sizeof(shape.curve_points));
+}
+
+void CalibrationStorage::getShapeNVS(const char* prefix, StickShape& shape, const StickShape& defaultShape) {
+  char key[12];
+  snprintf(key, sizeof(key), "%sdz", prefix);
+  shape.deadzone_percent = prefs.getFloat(key, defaultShape.deadzone_percent);
+  snprintf(key, sizeof(key), "%sodz", prefix);
+  shape.outer_deadzone_percent = prefs.getFloat(key, defaultShape.outer_deadzone_percent);
+  snprintf(key, sizeof(key), "%sadz", prefix);
+  shape.anti_deadzone_percent = prefs.getFloat(key, defaultShape.anti_deadzone_percent);
+  snprintf(key, sizeof(key), "%scirc", prefix);
+  shape.circularity_percent = prefs.getFloat(key, defaultShape.circularity_percent);
+  snprintf(key, sizeof(key), "%scurve", prefix);
+  shape.curve = prefs.getUChar(key, defaultShape.curve);
+  snprintf(key, sizeof(key), "%sexpo", prefix);
+  shape.expo_percent = prefs.getFloat(key, defaultShape.expo_percent);
+  snprintf(key, sizeof(key), "%spts", prefix);
+  if (prefs.getBytes(key, shape.curve_points, sizeof(shape.curve_points)) != sizeof(shape.curve_points)) {
+    memcpy(shape.curve_points, defaultShape.curve_points, sizeof(shape.curve_points));
+  }
+}
+
 void CalibrationStorage::saveSettings(const Settings& settings) {
   prefs.begin("cal", false);
-  prefs.putFloat("dz", settings.deadzone_percent);
   putAxisNVS("LX_", settings.LX);
   putAxisNVS("LY_", settings.LY);
   putAxisNVS("RX_", settings.RX);
   putAxisNVS("RY_", settings.RY);
+  putShapeNVS("L_", settings.left);
+  putShapeNVS("R_", settings.right);
   prefs.end();
 }
 
 void CalibrationStorage::loadSettings(Settings& settings) {
   prefs.begin("cal", true);
-  settings.deadzone_percent = prefs.getFloat("dz", 5.0f);
   getAxisNVS("LX_", settings.LX, {470, 1960, 3845, 0});
   getAxisNVS("LY_", settings.LY, {  0, 1927, 3180, 1});
   getAxisNVS("RX_", settings.RX, {302, 1975, 3900, 2});
   getAxisNVS("RY_", settings.RY, {170, 1940, 3538, 3});
+
+  // Older firmware stored a single per-axis deadzone under "dz"
+  StickShape defaultShape;
+  loadDefaultShape(defaultShape);
+  float legacyDz = prefs.getFloat("dz", defaultShape.deadzone_percent);
+  if (legacyDz < 0.0f) legacyDz = 0.0f;
+  if (legacyDz > 50.0f) legacyDz = 50.0f;
+  defaultShape.deadzone_percent = legacyDz;
+  getShapeNVS("L_", settings.left, defaultShape);
+  getShapeNVS("R_", settings.right, defaultShape);
   prefs.end();
 }
@@ -11,12 +11,15 @@ public:
   void loadDefaults(Settings& settings);
   void loadSettings(Settings& settings);
   void saveSettings(const Settings& settings);
+  static void loadDefaultShape(StickShape& shape);
 
 private:
   Preferences prefs;
   
   void putAxisNVS(const char* prefix, const CalAxis& axis);
   void getAxisNVS(const char* prefix, CalAxis& axis, const CalAxis& defaultAxis);
+  void putShapeNVS(const char* prefix, const StickShape& shape);
+  void getShapeNVS(const char* prefix, StickShape& shape, const StickShape& defaultShape);
 };
 
 #endif
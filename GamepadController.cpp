@@ -1,6 +1,7 @@
 #include "GamepadController.h"
 #include "PinConfig.h"
 #include <Arduino.h>
+#include <NimBLEDevice.h>
 
 GamepadController::GamepadController() 
   : compositeHID("ESP32 Controller", "Mystfit", 100), gamepad(nullptr) {}
@@ -103,3 +104,10 @@ void GamepadController::sendReport() {
 bool GamepadController::isConnected() {
   return compositeHID.isConnected();
 }
+
+bool GamepadController::isAdvertising() {
+  // compositeHID.begin() only spawns the BLE server task; advertising starts
+  // later from that task. Ask the NimBLE GAP layer directly so this is safe to
+  // poll before NimBLEDevice::init() has run.
+  return ble_gap_adv_active();
+}
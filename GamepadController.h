@@ -16,6 +16,7 @@ public:
   void updateThumbsticks(InputProcessor& processor, const Settings& settings);
   void sendReport();
   bool isConnected();
+  bool isAdvertising();
 
 private:
   XboxGamepadDevice* gamepad;
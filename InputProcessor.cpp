@@ -1,6 +1,5 @@
 #include "InputProcessor.h"
 #include "PinConfig.h"
-#include <math.h>
 
 InputProcessor::InputProcessor() 
   : leftX(0), leftY(0), rightX(0), rightY(0) {}
@@ -14,61 +13,57 @@ RawAxisData InputProcessor::readRawAxes() {
   return raw;
 }
 
-float InputProcessor::normalizeFromCal(int raw, int minVal, int centerVal, int maxVal) {
-  if (minVal >= maxVal) return 0.0f;
+int32_t InputProcessor::normalizeFromCal(int raw, const CalAxis& axis) {
+  if (axis.min >= axis.max) return 0;
 
-  if (raw >= centerVal) {
-    float span = (float)(maxVal - centerVal);
-    if (span <= 1.0f) span = 1.0f;
-    return (float)(raw - centerVal) / span;
+  int32_t value;
+  if (raw >= axis.center) {
+    int32_t span = axis.max - axis.center;
+    if (span < 1) span = 1;
+    value = (int32_t)(raw - axis.center) * STICK_Q15_ONE / span;
   } else {
-    float span = (float)(centerVal - minVal);
-    if (span <= 1.0f) span = 1.0f;
-    return -(float)(centerVal - raw) / span;
+    int32_t span = axis.center - axis.min;
+    if (span < 1) span = 1;
+    value = -(int32_t)(axis.center - raw) * STICK_Q15_ONE / span;
   }
+
+  if (value >  STICK_Q15_ONE) value =  STICK_Q15_ONE;
+  if (value < -STICK_Q15_ONE) value = -STICK_Q15_ONE;
+  return value;
 }
 
-float InputProcessor::applyDeadzone(float normalized, float deadzonePercent) {
-  float dz = deadzonePercent * 0.01f;
-  if (dz < 0.0f) dz = 0.0f;
-  if (dz > 0.5f) dz = 0.5f;
-  
-  float absVal = fabsf(normalized);
-  if (absVal <= dz) return 0.0f;
-  
-  float output = (absVal - dz) / (1.0f - dz);
-  return (normalized < 0) ? -output : output;
+int16_t InputProcessor::toStick(int32_t q15) {
+  int32_t value = q15 * XBOX_STICK_MAX / STICK_Q15_ONE;
+  if (value >  XBOX_STICK_MAX) value =  XBOX_STICK_MAX;
+  if (value < -XBOX_STICK_MAX) value = -XBOX_STICK_MAX;
+  return (int16_t)value;
 }
 
-int16_t InputProcessor::toStick(float normalized) {
-  float value = normalized * (float)XBOX_STICK_MAX;
-  if (value >  (float)XBOX_STICK_MAX) value =  (float)XBOX_STICK_MAX;
-  if (value < -(float)XBOX_STICK_MAX) value = -(float)XBOX_STICK_MAX;
-  return (int16_t)lroundf(value);
+void InputProcessor::configure(const Settings& settings) {
+  leftShaper.configure(settings.left);
+  rightShaper.configure(settings.right);
 }
 
 NormalizedAxisData InputProcessor::processAxes(const RawAxisData& raw, const Settings& settings) {
-  float nLX = normalizeFromCal(raw.LX, settings.LX.min, settings.LX.center, settings.LX.max);
-  float nLY = normalizeFromCal(raw.LY, settings.LY.min, settings.LY.center, settings.LY.max);
-  float nRX = normalizeFromCal(raw.RX, settings.RX.min, settings.RX.center, settings.RX.max);
-  float nRY = normalizeFromCal(raw.RY, settings.RY.min, settings.RY.center, settings.RY.max);
+  int32_t nLX = normalizeFromCal(raw.LX, settings.LX);
+  int32_t nLY = normalizeFromCal(raw.LY, settings.LY);
+  int32_t nRX = normalizeFromCal(raw.RX, settings.RX);
+  int32_t nRY = normalizeFromCal(raw.RY, settings.RY);
 
-  float dz = settings.deadzone_percent;
-  nLX = applyDeadzone(nLX, dz);
-  nLY = applyDeadzone(nLY, dz);
-  nRX = applyDeadzone(nRX, dz);
-  nRY = applyDeadzone(nRY, dz);
+  leftShaper.shape(nLX, nLY);
+  rightShaper.shape(nRX, nRY);
 
   leftX = toStick(nLX);
   leftY = toStick(nLY);
   rightX = toStick(nRX);
   rightY = toStick(nRY);
 
+  const float scale = 1.0f / (float)STICK_Q15_ONE;
   NormalizedAxisData result;
-  result.LX = nLX;
-  result.LY = nLY;
-  result.RX = nRX;
-  result.RY = nRY;
+  result.LX = nLX * scale;
+  result.LY = nLY * scale;
+  result.RX = nRX * scale;
+  result.RY = nRY * scale;
   return result;
 }
 
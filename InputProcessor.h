@@ -2,6 +2,7 @@
 #define INPUT_PROCESSOR_H
 
 #include "CalibrationModel.h"
+#include "StickShaper.h"
 #include <Arduino.h>
 
 #ifndef XBOX_STICK_MAX
@@ -12,6 +13,7 @@ class InputProcessor {
 public:
   InputProcessor();
   
+  void configure(const Settings& settings);
   RawAxisData readRawAxes();
   NormalizedAxisData processAxes(const RawAxisData& raw, const Settings& settings);
   
@@ -20,10 +22,10 @@ public:
 
 private:
   int16_t leftX, leftY, rightX, rightY;
+  StickShaper leftShaper, rightShaper;
   
-  float normalizeFromCal(int raw, int minVal, int centerVal, int maxVal);
-  float applyDeadzone(float normalized, float deadzonePercent);
-  int16_t toStick(float normalized);
+  int32_t normalizeFromCal(int raw, const CalAxis& axis);
+  int16_t toStick(int32_t q15);
 };
 
 #endif
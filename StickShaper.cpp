@@ -0,0 +1,132 @@
+#include "StickShaper.h"
+#include <math.h>
+
+StickShaper::StickShaper() {
+  mux = portMUX_INITIALIZER_UNLOCKED;
+  params.innerQ15 = 0;
+  params.outerQ15 = STICK_Q15_ONE;
+  params.antiQ15 = 0;
+  params.circularityQ15 = 0;
+  for (int i = 0; i < STICK_CURVE_LUT_SIZE; i++) {
+    int32_t in = (int32_t)i << STICK_CURVE_LUT_SHIFT;
+    params.curveLut[i] = (in > STICK_Q15_ONE) ? STICK_Q15_ONE : in;
+  }
+}
+
+int32_t StickShaper::percentToQ15(float percent, float maxPercent) {
+  if (percent < 0.0f) percent = 0.0f;
+  if (percent > maxPercent) percent = maxPercent;
+  return (int32_t)lroundf(percent * 0.01f * (float)STICK_Q15_ONE);
+}
+
+void StickShaper::configure(const StickShape& shape) {
+  Params next;
+  next.innerQ15 = percentToQ15(shape.deadzone_percent, 50.0f);
+  next.outerQ15 = STICK_Q15_ONE - percentToQ15(shape.outer_deadzone_percent, 50.0f);
+  if (next.outerQ15 <= next.innerQ15) next.outerQ15 = next.innerQ15 + 1;
+  next.antiQ15 = percentToQ15(shape.anti_deadzone_percent, 90.0f);
+  next.circularityQ15 = percentToQ15(shape.circularity_percent, 100.0f);
+
+  float k = shape.expo_percent * 0.01f;
+  if (k < 0.0f) k = 0.0f;
+  if (k > 1.0f) k = 1.0f;
+
+  for (int i = 0; i < STICK_CURVE_LUT_SIZE; i++) {
+    int32_t in = (int32_t)i << STICK_CURVE_LUT_SHIFT;
+    if (in > STICK_Q15_ONE) in = STICK_Q15_ONE;
+
+    int32_t out = in;
+    if (shape.curve == STICK_CURVE_EXPONENTIAL) {
+      float x = (float)in / (float)STICK_Q15_ONE;
+      float y = (1.0f - k) * x + k * x * x * x;
+      out = (int32_t)lroundf(y * (float)STICK_Q15_ONE);
+    } else if (shape.curve == STICK_CURVE_CUSTOM) {
+      int32_t pos = in * (STICK_CURVE_POINTS - 1);
+      int32_t seg = pos / STICK_Q15_ONE;
+      int32_t frac = pos % STICK_Q15_ONE;
+      if (seg >= STICK_CURVE_POINTS - 1) {
+        seg = STICK_CURVE_POINTS - 2;
+        frac = STICK_Q15_ONE;
+      }
+      int32_t a = (int32_t)shape.curve_points[seg] * STICK_Q15_ONE / 100;
+      int32_t b = (int32_t)shape.curve_points[seg + 1] * STICK_Q15_ONE / 100;
+      out = a + (b - a) * frac / STICK_Q15_ONE;
+    }
+
+    if (out < 0) out = 0;
+    if (out > STICK_Q15_ONE) out = STICK_Q15_ONE;
+    next.curveLut[i] = out;
+  }
+
+  portENTER_CRITICAL(&mux);
+  params = next;
+  portEXIT_CRITICAL(&mux);
+}
+
+uint32_t StickShaper::isqrt(uint32_t value) {
+  uint32_t result = 0;
+  uint32_t bit = 1UL << 30;
+  while (bit > value) bit >>= 2;
+
+  while (bit != 0) {
+    if (value >= result + bit) {
+      value -= result + bit;
+      result = (result >> 1) + bit;
+    } else {
+      result >>= 1;
+    }
+    bit >>= 2;
+  }
+  return result;
+}
+
+int32_t StickShaper::applyCurve(const Params& p, int32_t magnitude) {
+  if (magnitude <= 0) return p.curveLut[0];
+  if (magnitude >= STICK_Q15_ONE) return p.curveLut[STICK_CURVE_LUT_SIZE - 1];
+
+  int32_t idx = magnitude >> STICK_CURVE_LUT_SHIFT;
+  int32_t frac = magnitude & ((1 << STICK_CURVE_LUT_SHIFT) - 1);
+  int32_t a = p.curveLut[idx];
+  int32_t b = p.curveLut[idx + 1];
+  return a + (((b - a) * frac) >> STICK_CURVE_LUT_SHIFT);
+}
+
+void StickShaper::shape(int32_t& x, int32_t& y) const {
+  Params p;
+  portENTER_CRITICAL(&mux);
+  p = params;
+  portEXIT_CRITICAL(&mux);
+
+  uint32_t ax = (uint32_t)(x < 0 ? -x : x);
+  uint32_t ay = (uint32_t)(y < 0 ? -y : y);
+  int32_t mag = (int32_t)isqrt(ax * ax + ay * ay);
+  if (mag == 0) {
+    x = 0;
+    y = 0;
+    return;
+  }
+
+  // Pull square-gate diagonals (|v| up to sqrt(2)) back towards the unit circle.
+  int32_t radial = mag;
+  if (p.circularityQ15 > 0) {
+    int32_t cheb = (int32_t)(ax > ay ? ax : ay);
+    radial -= (mag - cheb) * p.circularityQ15 / STICK_Q15_ONE;
+  }
+
+  if (radial <= p.innerQ15) {
+    x = 0;
+    y = 0;
+    return;
+  }
+
+  int32_t t = (radial - p.innerQ15) * STICK_Q15_ONE / (p.outerQ15 - p.innerQ15);
+  if (t > STICK_Q15_ONE) t = STICK_Q15_ONE;
+
+  t = applyCurve(p, t);
+  if (p.antiQ15 > 0) {
+    t = p.antiQ15 + t * (STICK_Q15_ONE - p.antiQ15) / STICK_Q15_ONE;
+  }
+
+  x = (x * t + (x < 0 ? -mag : mag) / 2) / mag;
+  y = (y * t + (y < 0 ? -mag : mag) / 2) / mag;
+}
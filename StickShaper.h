@@ -0,0 +1,41 @@
+#ifndef STICK_SHAPER_H
+#define STICK_SHAPER_H
+
+#include "CalibrationModel.h"
+#include <Arduino.h>
+#include <stdint.h>
+
+#define STICK_Q15_ONE 32767
+#define STICK_CURVE_LUT_SHIFT 11
+#define STICK_CURVE_LUT_SIZE ((STICK_Q15_ONE >> STICK_CURVE_LUT_SHIFT) + 2)
+
+// Shapes one stick as a 2D vector in Q15 fixed point (-32767..32767 per axis).
+// configure() does the float/percent conversion once; shape() is integer only.
+// configure() may run on the web server task while shape() runs in loop(), so
+// the parameters are built aside and swapped in under a critical section.
+class StickShaper {
+public:
+  StickShaper();
+
+  void configure(const StickShape& shape);
+  void shape(int32_t& x, int32_t& y) const;
+
+  static uint32_t isqrt(uint32_t value);
+
+private:
+  struct Params {
+    int32_t innerQ15;
+    int32_t outerQ15;
+    int32_t antiQ15;
+    int32_t circularityQ15;
+    int32_t curveLut[STICK_CURVE_LUT_SIZE];
+  };
+
+  Params params;
+  mutable portMUX_TYPE mux;
+
+  static int32_t percentToQ15(float percent, float maxPercent);
+  static int32_t applyCurve(const Params& p, int32_t magnitude);
+};
+
+#endif
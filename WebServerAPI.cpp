@@ -2,11 +2,12 @@
 #include "PinConfig.h"
 #include <WiFi.h>
 #include <ArduinoJson.h>
+#include <string.h>
 
 WebServerAPI* WebServerAPI::instance = nullptr;
 
-WebServerAPI::WebServerAPI(Settings& settings, CalibrationStorage& storage, InputProcessor& processor)
-  : server(80), settings(settings), storage(storage), processor(processor) {
+WebServerAPI::WebServerAPI(Settings& settings, CalibrationStorage& storage, InputProcessor& processor, const BootTimer& bootTimer)
+  : server(80), settings(settings), storage(storage), processor(processor), bootTimer(bootTimer) {
   instance = this;
 }
 
@@ -34,11 +35,13 @@ void WebServerAPI::setupRoutes() {
   server.on("/set", HTTP_POST, [](AsyncWebServerRequest* req){}, NULL, handlePostSet);
   server.on("/raw", HTTP_GET, handleGetRaw);
   server.on("/val", HTTP_GET, handleGetVal);
+  server.on("/boot", HTTP_GET, handleGetBoot);
 
   server.on("/settings", HTTP_OPTIONS, handleOptions);
   server.on("/set", HTTP_OPTIONS, handleOptions);
   server.on("/raw", HTTP_OPTIONS, handleOptions);
   server.on("/val", HTTP_OPTIONS, handleOptions);
+  server.on("/boot", HTTP_OPTIONS, handleOptions);
 }
 
 void WebServerAPI::begin() {
@@ -52,6 +55,60 @@ void WebServerAPI::addCORS(AsyncWebServerResponse* response) {
   response->addHeader("Access-Control-Max-Age", "600");
 }
 
+void WebServerAPI::writeShapeJson(JsonObject obj, const StickShape& shape) {
+  obj["deadzone_percent"] = shape.deadzone_percent;
+  obj["outer_deadzone_percent"] = shape.outer_deadzone_percent;
+  obj["anti_deadzone_percent"] = shape.anti_deadzone_percent;
+  obj["circularity_percent"] = shape.circularity_percent;
+  obj["curve"] = shape.curve;
+  obj["expo_percent"] = shape.expo_percent;
+
+  JsonArray points = obj.createNestedArray("curve_points");
+  for (int i = 0; i < STICK_CURVE_POINTS; i++) {
+    points.add(shape.curve_points[i]);
+  }
+}
+
+bool WebServerAPI::readPercentJson(JsonObject obj, const char* key, float maxPercent, float& value) {
+  if (!obj.containsKey(key)) return true;
+  if (!obj[key].is<float>()) return false;
+
+  float v = obj[key].as<float>();
+  if (!(v >= 0.0f && v <= maxPercent)) return false;
+  value = v;
+  return true;
+}
+
+// Returns nullptr on success, or the error code to report for the first bad field.
+const char* WebServerAPI::readShapeJson(JsonObject obj, StickShape& shape) {
+  if (!readPercentJson(obj, "deadzone_percent", 50.0f, shape.deadzone_percent)) return "bad_deadzone_percent";
+  if (!readPercentJson(obj, "outer_deadzone_percent", 50.0f, shape.outer_deadzone_percent)) return "bad_outer_deadzone_percent";
+  if (!readPercentJson(obj, "anti_deadzone_percent", 90.0f, shape.anti_deadzone_percent)) return "bad_anti_deadzone_percent";
+  if (!readPercentJson(obj, "circularity_percent", 100.0f, shape.circularity_percent)) return "bad_circularity_percent";
+  if (!readPercentJson(obj, "expo_percent", 100.0f, shape.expo_percent)) return "bad_expo_percent";
+
+  if (obj.containsKey("curve")) {
+    if (!obj["curve"].is<int>()) return "bad_curve";
+    int curve = obj["curve"].as<int>();
+    if (curve < STICK_CURVE_LINEAR || curve > STICK_CURVE_CUSTOM) return "bad_curve";
+    shape.curve = (uint8_t)curve;
+  }
+
+  if (obj.containsKey("curve_points")) {
+    JsonArray points = obj["curve_points"];
+    if (points.isNull() || points.size() != STICK_CURVE_POINTS) return "bad_curve_points";
+    uint8_t parsed[STICK_CURVE_POINTS];
+    for (int i = 0; i < STICK_CURVE_POINTS; i++) {
+      if (!points[i].is<int>()) return "bad_curve_points";
+      int p = points[i].as<int>();
+      if (p < 0 || p > 100) return "bad_curve_points";
+      parsed[i] = (uint8_t)p;
+    }
+    memcpy(shape.curve_points, parsed, sizeof(parsed));
+  }
+  return nullptr;
+}
+
 void WebServerAPI::handleOptions(AsyncWebServerRequest* request) {
   AsyncWebServerResponse* response = request->beginResponse(204);
   request->send(response);
@@ -108,8 +165,8 @@ void WebServerAPI::handleGetSettings(AsyncWebServerRequest* request) {
     return;
   }
   
-  StaticJsonDocument<512> doc;
-  doc["deadzone_percent"] = instance->settings.deadzone_percent;
+  StaticJsonDocument<1536> doc;
+  doc["deadzone_percent"] = instance->settings.left.deadzone_percent;
   
   JsonObject axes = doc.createNestedObject("axes");
   JsonObject obj;
@@ -138,6 +195,37 @@ void WebServerAPI::handleGetSettings(AsyncWebServerRequest* request) {
   obj["max"] = instance->settings.RY.max;
   obj["center"] = instance->settings.RY.center;
 
+  JsonObject sticks = doc.createNestedObject("sticks");
+  writeShapeJson(sticks.createNestedObject("left"), instance->settings.left);
+  writeShapeJson(sticks.createNestedObject("right"), instance->settings.right);
+
+  String output;
+  serializeJson(doc, output);
+  request->send(200, "application/json", output);
+}
+
+void WebServerAPI::handleGetBoot(AsyncWebServerRequest* request) {
+  if (!instance) {
+    request->send(500, "application/json", "{\"error\":\"server not initialized\"}");
+    return;
+  }
+
+  const BootTimer& timer = instance->bootTimer;
+  StaticJsonDocument<512> doc;
+
+  JsonObject phases = doc.createNestedObject("phases_us");
+  for (int i = 0; i < BOOT_PHASE_COUNT; i++) {
+    BootPhase phase = (BootPhase)i;
+    if (timer.reached(phase)) phases[BootTimer::phaseName(phase)] = (double)timer.get(phase);
+    else phases[BootTimer::phaseName(phase)] = nullptr;
+  }
+
+  if (timer.reached(BOOT_ADVERTISING)) doc["boot_to_advertising_ms"] = timer.get(BOOT_ADVERTISING) / 1000.0;
+  else doc["boot_to_advertising_ms"] = nullptr;
+
+  if (timer.reached(BOOT_FIRST_REPORT)) doc["boot_to_first_report_ms"] = timer.get(BOOT_FIRST_REPORT) / 1000.0;
+  else doc["boot_to_first_report_ms"] = nullptr;
+
   String output;
   serializeJson(doc, output);
   request->send(200, "application/json", output);
@@ -155,17 +243,46 @@ void WebServerAPI::handlePostSet(AsyncWebServerRequest* request, uint8_t* data,
   body += String((const char*)data).substring(0, len);
   if (index + len != total) return;
 
-  StaticJsonDocument<1024> doc;
+  StaticJsonDocument<2048> doc;
   DeserializationError err = deserializeJson(doc, body);
   if (err) {
     request->send(400, "application/json", "{\"ok\":false,\"err\":\"bad_json\"}");
     return;
   }
 
-  if (doc.containsKey("deadzone_percent")) {
-    instance->settings.deadzone_percent = doc["deadzone_percent"].as<float>();
+  StickShape left = instance->settings.left;
+  StickShape right = instance->settings.right;
+
+  JsonObject sticks = doc["sticks"];
+  if (!sticks.isNull()) {
+    JsonObject st;
+    const char* shapeErr = nullptr;
+
+    st = sticks["left"];
+    if (!st.isNull()) shapeErr = readShapeJson(st, left);
+
+    st = sticks["right"];
+    if (!shapeErr && !st.isNull()) shapeErr = readShapeJson(st, right);
+
+    if (shapeErr) {
+      String response = String("{\"ok\":false,\"err\":\"") + shapeErr + "\"}";
+      request->send(400, "application/json", response);
+      return;
+    }
+  } else if (doc.containsKey("deadzone_percent")) {
+    // Legacy shared deadzone, only honoured when no per-stick shaping is sent
+    float dz = 0.0f;
+    if (!readPercentJson(doc.as<JsonObject>(), "deadzone_percent", 50.0f, dz)) {
+      request->send(400, "application/json", "{\"ok\":false,\"err\":\"bad_deadzone_percent\"}");
+      return;
+    }
+    left.deadzone_percent = dz;
+    right.deadzone_percent = dz;
   }
 
+  instance->settings.left = left;
+  instance->settings.right = right;
+
   JsonObject axes = doc["axes"];
   if (!axes.isNull()) {
     JsonObject ax;
@@ -203,6 +320,7 @@ void WebServerAPI::handlePostSet(AsyncWebServerRequest* request, uint8_t* data,
     }
   }
 
+  instance->processor.configure(instance->settings);
   instance->storage.saveSettings(instance->settings);
   request->send(200, "application/json", "{\"ok\":true}");
 }
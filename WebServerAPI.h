@@ -2,13 +2,15 @@
 #define WEB_SERVER_API_H
 
 #include <ESPAsyncWebServer.h>
+#include <ArduinoJson.h>
 #include "CalibrationModel.h"
 #include "CalibrationStorage.h"
 #include "InputProcessor.h"
+#include "BootTimer.h"
 
 class WebServerAPI {
 public:
-  WebServerAPI(Settings& settings, CalibrationStorage& storage, InputProcessor& processor);
+  WebServerAPI(Settings& settings, CalibrationStorage& storage, InputProcessor& processor, const BootTimer& bootTimer);
   
   void init();
   void begin();
@@ -18,6 +20,7 @@ private:
   Settings& settings;
   CalibrationStorage& storage;
   InputProcessor& processor;
+  const BootTimer& bootTimer;
   
   static WebServerAPI* instance;
   
@@ -25,11 +28,15 @@ private:
   void setupCORS();
   
   static void addCORS(AsyncWebServerResponse* response);
+  static void writeShapeJson(JsonObject obj, const StickShape& shape);
+  static bool readPercentJson(JsonObject obj, const char* key, float maxPercent, float& value);
+  static const char* readShapeJson(JsonObject obj, StickShape& shape);
   static void handleOptions(AsyncWebServerRequest* request);
   
   static void handleGetRaw(AsyncWebServerRequest* request);
   static void handleGetVal(AsyncWebServerRequest* request);
   static void handleGetSettings(AsyncWebServerRequest* request);
+  static void handleGetBoot(AsyncWebServerRequest* request);
   static void handlePostSet(AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total);
 };
 
@@ -9,6 +9,7 @@
 #include <ArduinoJson.h>
 #include <Preferences.h>
 #include <inttypes.h>
+#include <esp_timer.h>
 
 #include "PinConfig.h"
 #include "CalibrationModel.h"
@@ -17,34 +18,78 @@
 #include "GamepadController.h"
 #include "VibrationHandler.h"
 #include "WebServerAPI.h"
+#include "BootTimer.h"
+
+// Wi-Fi and the web server share the radio and core 0 with NimBLE, so they are
+// held back until the host has finished setting up the link (encryption, GATT
+// discovery, report subscription), or until no host has shown up for a while.
+#define WEB_START_AFTER_CONNECT_MS 5000
+#define WEB_START_NO_HOST_MS 10000
+
+#define ADVERTISING_POLL_WINDOW_MS 5000
 
 Settings settings;
 CalibrationStorage calibrationStorage;
 InputProcessor inputProcessor;
 GamepadController gamepadController;
-WebServerAPI* webServerAPI;
+BootTimer bootTimer;
+WebServerAPI* webServerAPI = nullptr;
+bool webServerStarting = false;
+
+void webServerTask(void* param) {
+  webServerAPI = new WebServerAPI(settings, calibrationStorage, inputProcessor, bootTimer);
+  webServerAPI->init();
+  webServerAPI->begin();
+  bootTimer.mark(BOOT_WEB_STARTED);
+  vTaskDelete(NULL);
+}
+
+void startWebServerIfDue() {
+  if (webServerStarting) return;
+  uint64_t nowMs = (uint64_t)esp_timer_get_time() / 1000;
+  if (bootTimer.reached(BOOT_FIRST_REPORT)) {
+    if (nowMs - bootTimer.get(BOOT_FIRST_REPORT) / 1000 < WEB_START_AFTER_CONNECT_MS) return;
+  } else if (nowMs < WEB_START_NO_HOST_MS) {
+    return;
+  }
+
+  webServerStarting = true;
+  xTaskCreatePinnedToCore(webServerTask, "webServer", 8192, NULL, 1, NULL, 0);
+}
 
 void setup() {
   Serial.begin(115200);
-  delay(100);
-
-  calibrationStorage.loadDefaults(settings);
-  calibrationStorage.loadSettings(settings);
+  bootTimer.mark(BOOT_SETUP_START);
 
   gamepadController.init();
+  bootTimer.mark(BOOT_HID_STARTED);
 
-  webServerAPI = new WebServerAPI(settings, calibrationStorage, inputProcessor);
-  webServerAPI->init();
-  webServerAPI->begin();
+  calibrationStorage.loadDefaults(settings);
+  calibrationStorage.loadSettings(settings);
+  inputProcessor.configure(settings);
+  bootTimer.mark(BOOT_SETTINGS_LOADED);
 }
 
 void loop() {
+  // Only the first advertising after power-on counts; once a report has gone
+  // out, a later re-advertise after a disconnect is not a boot phase.
+  bool waitingForAdvertising = !bootTimer.reached(BOOT_ADVERTISING) && !bootTimer.reached(BOOT_FIRST_REPORT);
+  if (waitingForAdvertising && gamepadController.isAdvertising()) {
+    bootTimer.mark(BOOT_ADVERTISING);
+    waitingForAdvertising = false;
+  }
+  startWebServerIfDue();
+
   if (gamepadController.isConnected()) {
     gamepadController.updateButtons();
     gamepadController.updateThumbsticks(inputProcessor, settings);
     gamepadController.sendReport();
+    bootTimer.mark(BOOT_FIRST_REPORT);
     delay(10);
   } else {
-    delay(20);
+    // Poll tightly until advertising is seen so its timestamp stays accurate,
+    // but only for the first ADVERTISING_POLL_WINDOW_MS in case BLE never comes up
+    bool fastPoll = waitingForAdvertising && millis() < ADVERTISING_POLL_WINDOW_MS;
+    delay(fastPoll ? 1 : 20);
   }
 }